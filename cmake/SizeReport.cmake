@@ -0,0 +1,71 @@
+# Flash/RAM/stack budget report for firmware targets.
+#
+#   target_size_report(<target> FLASH_BUDGET <bytes> RAM_BUDGET <bytes> [FLASH_ORIGIN <address>]
+#                      [RAM_ORIGIN <address>] [STACK_BUDGET <bytes>] [VECTOR_COUNT <entries>])
+#
+# Adds <target>_size which writes size/<target>.txt into the build directory and fails
+# if a budget is exceeded. Sections are summed by the window they are placed in, flash from
+# FLASH_ORIGIN (default 0) and ram from RAM_ORIGIN (default 0x20000000), each as long as its
+# budget. The report lists every section and symbol together with the static worst-case stack
+# depth taken from the call graph gcc emits (-fcallgraph-info=su): main (or the reset handler
+# running it) plus the deepest handler of the vector table plus one exception frame. Without a
+# STACK_BUDGET the depth is checked against the stack section, or the ram left after data and
+# bss. The report is diffed against size_baseline/<target>.txt in the source tree.
+#
+# size_report runs all reports, size_baseline stores the current reports as new baseline.
+
+set(SIZE_REPORT_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/size_report_script.cmake)
+set(SIZE_REPORT_BASELINE_DIR ${CMAKE_SOURCE_DIR}/size_baseline)
+
+if(NOT TARGET size_report)
+    add_custom_target(size_report)
+    add_custom_target(size_baseline)
+endif()
+
+function(target_size_report target)
+    cmake_parse_arguments(ARG "" "FLASH_BUDGET;RAM_BUDGET;FLASH_ORIGIN;RAM_ORIGIN;STACK_BUDGET;VECTOR_COUNT" "" ${ARGN})
+    if(NOT ARG_FLASH_ORIGIN)
+        set(ARG_FLASH_ORIGIN 0)
+    endif()
+    if(NOT ARG_RAM_ORIGIN)
+        set(ARG_RAM_ORIGIN 0x20000000)
+    endif()
+    if(NOT ARG_STACK_BUDGET)
+        set(ARG_STACK_BUDGET 0)
+    endif()
+    if(NOT ARG_VECTOR_COUNT)
+        # 16 cortex-m0+ exceptions and 31 ATSAMC21 interrupts
+        set(ARG_VECTOR_COUNT 47)
+    endif()
+
+    target_compile_options(${target} PRIVATE -fcallgraph-info=su)
+
+    set(report ${CMAKE_BINARY_DIR}/size/${target}.txt)
+    set(args
+        -DELF=$<TARGET_FILE:${target}>
+        -DNM=${CMAKE_NM}
+        -DOBJDUMP=${CMAKE_OBJDUMP}
+        -DVECTOR_COUNT=${ARG_VECTOR_COUNT}
+        -DNAME=${target}
+        -DCALLGRAPH_DIR=${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/${target}.dir
+        -DFLASH_ORIGIN=${ARG_FLASH_ORIGIN}
+        -DFLASH_BUDGET=${ARG_FLASH_BUDGET}
+        -DRAM_ORIGIN=${ARG_RAM_ORIGIN}
+        -DRAM_BUDGET=${ARG_RAM_BUDGET}
+        -DSTACK_BUDGET=${ARG_STACK_BUDGET}
+        -DBASELINE=${SIZE_REPORT_BASELINE_DIR}/${target}.txt
+        -DOUTPUT=${report})
+
+    add_custom_target(${target}_size
+        COMMAND ${CMAKE_COMMAND} ${args} -P ${SIZE_REPORT_SCRIPT}
+        DEPENDS ${target}
+        VERBATIM)
+    add_custom_target(${target}_size_baseline
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${SIZE_REPORT_BASELINE_DIR}
+        COMMAND ${CMAKE_COMMAND} -E copy ${report} ${SIZE_REPORT_BASELINE_DIR}/${target}.txt
+        DEPENDS ${target}_size
+        VERBATIM)
+
+    add_dependencies(size_report ${target}_size)
+    add_dependencies(size_baseline ${target}_size_baseline)
+endfunction()
@@ -0,0 +1,370 @@
+# Invoked by target_size_report() in script mode, see SizeReport.cmake.
+#
+# Required: ELF NM OBJDUMP VECTOR_COUNT NAME CALLGRAPH_DIR FLASH_ORIGIN FLASH_BUDGET RAM_ORIGIN
+#           RAM_BUDGET STACK_BUDGET BASELINE OUTPUT
+
+cmake_minimum_required(VERSION 3.16)
+
+# the exception frame pushed by the core when an interrupt preempts the main stack
+set(EXCEPTION_FRAME_SIZE 32)
+
+function(percent out value budget)
+    if(budget GREATER 0)
+        math(EXPR tenth "(${value} * 1000) / ${budget}")
+        math(EXPR whole "${tenth} / 10")
+        math(EXPR frac "${tenth} % 10")
+        set(${out} "${whole}.${frac}%" PARENT_SCOPE)
+    else()
+        set(${out} "-" PARENT_SCOPE)
+    endif()
+endfunction()
+
+function(signed out value)
+    if(value GREATER 0)
+        set(${out} "+${value}" PARENT_SCOPE)
+    else()
+        set(${out} "${value}" PARENT_SCOPE)
+    endif()
+endfunction()
+
+# sections and totals, a section counts against flash if it is loaded from the flash window and
+# against ram if it runs in the ram window; .data counts twice, eeprom and .noinit are neither
+execute_process(COMMAND ${OBJDUMP} -h -w ${ELF} OUTPUT_VARIABLE sections_out RESULT_VARIABLE res)
+if(res)
+    message(FATAL_ERROR "${OBJDUMP} failed on ${ELF}")
+endif()
+string(REPLACE "\n" ";" section_lines "${sections_out}")
+
+# origins may be given in hex, if() only compares decimals
+math(EXPR FLASH_ORIGIN "${FLASH_ORIGIN}")
+math(EXPR RAM_ORIGIN "${RAM_ORIGIN}")
+math(EXPR flash_end "${FLASH_ORIGIN} + ${FLASH_BUDGET}")
+math(EXPR ram_end "${RAM_ORIGIN} + ${RAM_BUDGET}")
+set(flash 0)
+set(ram 0)
+set(sections "")
+foreach(line ${section_lines})
+    if(line MATCHES "^ *[0-9]+ ([^ ]+) +([0-9a-f]+) +([0-9a-f]+) +([0-9a-f]+) +[0-9a-f]+ +2\\*\\*[0-9]+ +(.*)$")
+        set(section_name ${CMAKE_MATCH_1})
+        set(section_flags "${CMAKE_MATCH_5}")
+        math(EXPR section_size "0x${CMAKE_MATCH_2}")
+        math(EXPR section_vma "0x${CMAKE_MATCH_3}")
+        math(EXPR section_lma "0x${CMAKE_MATCH_4}")
+        if(section_size GREATER 0 AND section_flags MATCHES "ALLOC")
+            set(region "")
+            if(section_flags MATCHES "LOAD" AND section_lma GREATER_EQUAL FLASH_ORIGIN
+               AND section_lma LESS flash_end)
+                math(EXPR flash "${flash} + ${section_size}")
+                set(region "flash")
+            endif()
+            if(section_vma GREATER_EQUAL RAM_ORIGIN AND section_vma LESS ram_end)
+                math(EXPR ram "${ram} + ${section_size}")
+                set(region "${region} ram")
+                if(section_name MATCHES "stack" AND NOT section_flags MATCHES "LOAD")
+                    set(stack_section ${section_name})
+                    set(stack_section_size ${section_size})
+                endif()
+            endif()
+            string(STRIP "${region}" region)
+            if(region STREQUAL "")
+                set(region "outside")
+            endif()
+            string(REPLACE " " "+" region "${region}")
+            list(APPEND sections ${section_name})
+            set(section_size_${section_name} ${section_size})
+            set(section_vma_${section_name} ${section_vma})
+            set(section_region_${section_name} ${region})
+        endif()
+    endif()
+endforeach()
+
+# StackProtector guards the stack region of the linker script, without one the stack grows down
+# into whatever ram is left after data and bss
+if(STACK_BUDGET GREATER 0)
+    set(stack_source "set by STACK_BUDGET")
+elseif(DEFINED stack_section)
+    set(STACK_BUDGET ${stack_section_size})
+    set(stack_source "size of ${stack_section}")
+else()
+    math(EXPR STACK_BUDGET "${RAM_BUDGET} - ${ram}")
+    set(stack_source "ram left after data and bss")
+endif()
+
+# symbols, sizes are decimal; names stay mangled so they survive as list elements
+execute_process(COMMAND ${NM} -S --size-sort --radix=d ${ELF} OUTPUT_VARIABLE nm_out RESULT_VARIABLE res)
+if(res)
+    message(FATAL_ERROR "${NM} failed on ${ELF}")
+endif()
+string(REPLACE "\n" ";" nm_lines "${nm_out}")
+
+# worst case stack depth from the gcc call graph
+file(GLOB_RECURSE callgraph_files ${CALLGRAPH_DIR}/*.ci)
+set(nodes "")
+foreach(file ${callgraph_files})
+    file(STRINGS ${file} lines REGEX "^(node|edge):")
+    foreach(line ${lines})
+        string(REPLACE "\\n" "|" line "${line}")
+        if(line MATCHES "^node: { title: \"([^\"]+)\" label: \"[^|\"]*\\|[^|\"]*\\|([0-9]+) bytes \\(([a-z,]+)\\)")
+            string(MAKE_C_IDENTIFIER "${CMAKE_MATCH_1}" id)
+            list(APPEND nodes ${id})
+            set(name_${id} "${CMAKE_MATCH_1}")
+            set(frame_${id} ${CMAKE_MATCH_2})
+            if(NOT CMAKE_MATCH_3 STREQUAL "static")
+                set(unbounded_${id} "${CMAKE_MATCH_3} frame")
+            endif()
+        elseif(line MATCHES "^node: { title: \"([^\"]+)\"")
+            # external or not compiled with -fcallgraph-info, counted as 0 bytes
+            string(MAKE_C_IDENTIFIER "${CMAKE_MATCH_1}" id)
+            list(APPEND nodes ${id})
+            set(name_${id} "${CMAKE_MATCH_1}")
+            if(NOT DEFINED frame_${id})
+                set(frame_${id} 0)
+            endif()
+        elseif(line MATCHES "^edge: { sourcename: \"([^\"]+)\" targetname: \"([^\"]+)\"")
+            string(MAKE_C_IDENTIFIER "${CMAKE_MATCH_1}" from)
+            string(MAKE_C_IDENTIFIER "${CMAKE_MATCH_2}" to)
+            list(APPEND calls_${from} ${to})
+            set(called_${to} TRUE)
+            if(CMAKE_MATCH_2 STREQUAL "__indirect_call")
+                set(unbounded_${from} "indirect call")
+            endif()
+        endif()
+    endforeach()
+endforeach()
+list(REMOVE_DUPLICATES nodes)
+
+# depth_<id> = frame + deepest callee, path_<id> = the call chain producing it
+macro(stack_depth id)
+    if(NOT DEFINED depth_${id})
+        if(visiting_${id})
+            set(unbounded_${id} "recursion")
+            set(depth_${id} 0)
+            set(path_${id} ${id})
+        else()
+            set(visiting_${id} TRUE)
+            set(deepest_${id} 0)
+            set(deepest_path_${id} "")
+            foreach(callee_${id} ${calls_${id}})
+                stack_depth(${callee_${id}})
+                if(depth_${callee_${id}} GREATER deepest_${id})
+                    set(deepest_${id} ${depth_${callee_${id}}})
+                    set(deepest_path_${id} ${path_${callee_${id}}})
+                endif()
+                if(DEFINED unbounded_${callee_${id}} AND NOT DEFINED unbounded_${id})
+                    set(unbounded_${id} "${unbounded_${callee_${id}}}")
+                endif()
+            endforeach()
+            math(EXPR depth_${id} "${frame_${id}} + ${deepest_${id}}")
+            set(path_${id} ${id} ${deepest_path_${id}})
+            set(visiting_${id} FALSE)
+        endif()
+    endif()
+endmacro()
+
+# the vector table sits at the start of flash, entry 0 is the initial stack pointer and entry 1
+# the reset handler which runs main, every other entry is an exception or interrupt handler
+foreach(line ${nm_lines})
+    if(line MATCHES "^([0-9]+) [0-9]+ [TtWw] (.+)$")
+        math(EXPR address "${CMAKE_MATCH_1} & ~1")
+        set(function_at_${address} "${CMAKE_MATCH_2}")
+    endif()
+endforeach()
+
+set(vectors "")
+if(flash GREATER 0)
+    math(EXPR vector_end "${FLASH_ORIGIN} + ${VECTOR_COUNT} * 4")
+    execute_process(
+        COMMAND ${OBJDUMP} -s --start-address=${FLASH_ORIGIN} --stop-address=${vector_end} ${ELF}
+        OUTPUT_VARIABLE vector_dump
+        RESULT_VARIABLE res)
+    if(res)
+        message(FATAL_ERROR "${OBJDUMP} failed on ${ELF}")
+    endif()
+    string(REPLACE "\n" ";" vector_lines "${vector_dump}")
+    foreach(line ${vector_lines})
+        if(line MATCHES "^ [0-9a-f]+ (([0-9a-f]+ ?)+)  ")
+            string(REPLACE " " ";" words "${CMAKE_MATCH_1}")
+            foreach(word ${words})
+                if(word MATCHES "^(..)(..)(..)(..)$")
+                    # little endian
+                    math(EXPR address "0x${CMAKE_MATCH_4}${CMAKE_MATCH_3}${CMAKE_MATCH_2}${CMAKE_MATCH_1} & ~1")
+                    list(APPEND vectors ${address})
+                endif()
+            endforeach()
+        endif()
+    endforeach()
+endif()
+
+set(reset_name "")
+set(isr_names "")
+set(index 0)
+foreach(address ${vectors})
+    if(index GREATER 0 AND DEFINED function_at_${address})
+        if(index EQUAL 1)
+            set(reset_name "${function_at_${address}}")
+        else()
+            list(APPEND isr_names "${function_at_${address}}")
+        endif()
+    endif()
+    math(EXPR index "${index} + 1")
+endforeach()
+list(REMOVE_DUPLICATES isr_names)
+if(reset_name STREQUAL "")
+    message(WARNING "${NAME}: no vector table found at the start of flash, only main is analysed")
+endif()
+
+# main is looked up by name, it may be called from the reset handler or be a root of its own
+set(thread_roots "")
+foreach(root_name main ${reset_name})
+    string(MAKE_C_IDENTIFIER "${root_name}" id)
+    if(DEFINED frame_${id})
+        stack_depth(${id})
+        list(APPEND thread_roots ${id})
+    endif()
+endforeach()
+list(REMOVE_DUPLICATES thread_roots)
+
+set(isr_roots "")
+foreach(root_name ${isr_names})
+    string(MAKE_C_IDENTIFIER "${root_name}" id)
+    if(NOT DEFINED frame_${id})
+        # handler outside the call graph, e.g. assembler or library code
+        list(APPEND nodes ${id})
+        set(name_${id} "${root_name}")
+        set(frame_${id} 0)
+        set(unbounded_${id} "no call graph")
+    endif()
+    stack_depth(${id})
+    list(APPEND isr_roots ${id})
+endforeach()
+
+# interrupts preempt main, all isr share one priority so only the deepest one counts
+set(thread_depth 0)
+set(isr_depth 0)
+foreach(id ${thread_roots})
+    if(depth_${id} GREATER thread_depth)
+        set(thread_depth ${depth_${id}})
+    endif()
+endforeach()
+foreach(id ${isr_roots})
+    if(depth_${id} GREATER isr_depth)
+        set(isr_depth ${depth_${id}})
+    endif()
+endforeach()
+math(EXPR stack "${thread_depth} + ${isr_depth} + ${EXCEPTION_FRAME_SIZE}")
+
+# baseline
+set(base_flash "")
+set(base_ram "")
+set(base_stack "")
+set(base_symbols "")
+if(EXISTS ${BASELINE})
+    file(STRINGS ${BASELINE} base_lines)
+    foreach(line ${base_lines})
+        if(line MATCHES "^flash ([0-9]+)")
+            set(base_flash ${CMAKE_MATCH_1})
+        elseif(line MATCHES "^ram ([0-9]+)")
+            set(base_ram ${CMAKE_MATCH_1})
+        elseif(line MATCHES "^stack ([0-9]+)")
+            set(base_stack ${CMAKE_MATCH_1})
+        elseif(line MATCHES "^symbol [A-Za-z] ([0-9]+) (.+)$")
+            string(MAKE_C_IDENTIFIER "${CMAKE_MATCH_2}" id)
+            list(APPEND base_symbols ${id})
+            set(base_name_${id} "${CMAKE_MATCH_2}")
+            set(base_size_${id} ${CMAKE_MATCH_1})
+        endif()
+    endforeach()
+endif()
+
+# report
+percent(flash_pct ${flash} ${FLASH_BUDGET})
+percent(ram_pct ${ram} ${RAM_BUDGET})
+percent(stack_pct ${stack} ${STACK_BUDGET})
+
+set(report "# size report ${NAME}\n")
+string(APPEND report "flash ${flash} of ${FLASH_BUDGET} (${flash_pct})\n")
+string(APPEND report "ram ${ram} of ${RAM_BUDGET} (${ram_pct})\n")
+string(APPEND report "stack ${stack} of ${STACK_BUDGET} (${stack_pct}) ${stack_source}\n")
+
+string(APPEND report "\n# sections, outside the flash and ram budgets: eeprom, .noinit\n")
+foreach(section_name ${sections})
+    string(APPEND report
+        "section ${section_name} ${section_size_${section_name}} @${section_vma_${section_name}} ${section_region_${section_name}}\n")
+endforeach()
+
+string(APPEND report "\n# stack, worst case call chain of main/reset and of every interrupt handler\n")
+foreach(kind thread isr)
+    foreach(id ${${kind}_roots})
+        set(chain "")
+        foreach(step ${path_${id}})
+            string(APPEND chain " ${name_${step}}(${frame_${step}})")
+        endforeach()
+        set(note "")
+        if(DEFINED unbounded_${id})
+            set(note " UNBOUNDED: ${unbounded_${id}}")
+        endif()
+        string(APPEND report "${kind} ${depth_${id}} ${name_${id}}${note}:${chain}\n")
+    endforeach()
+endforeach()
+
+string(APPEND report "\n# symbols\n")
+set(symbols "")
+set(diff "")
+foreach(line ${nm_lines})
+    if(line MATCHES "^[0-9]+ ([0-9]+) ([A-Za-z]) (.+)$")
+        math(EXPR symbol_size "${CMAKE_MATCH_1}")
+        set(symbol_name "${CMAKE_MATCH_3}")
+        string(APPEND report "symbol ${CMAKE_MATCH_2} ${symbol_size} ${symbol_name}\n")
+        string(MAKE_C_IDENTIFIER "${symbol_name}" id)
+        list(APPEND symbols ${id})
+        if(EXISTS ${BASELINE})
+            if(NOT DEFINED base_size_${id})
+                string(APPEND diff "  new     +${symbol_size} ${symbol_name}\n")
+            elseif(NOT symbol_size EQUAL base_size_${id})
+                math(EXPR delta "${symbol_size} - ${base_size_${id}}")
+                signed(delta ${delta})
+                string(APPEND diff "  changed ${delta} ${symbol_name}\n")
+            endif()
+        endif()
+    endif()
+endforeach()
+foreach(id ${base_symbols})
+    list(FIND symbols ${id} found)
+    if(found EQUAL -1)
+        string(APPEND diff "  removed -${base_size_${id}} ${base_name_${id}}\n")
+    endif()
+endforeach()
+
+file(WRITE ${OUTPUT} "${report}")
+
+message(STATUS "${NAME}: flash ${flash}/${FLASH_BUDGET} (${flash_pct}) ram ${ram}/${RAM_BUDGET} (${ram_pct}) stack ${stack}/${STACK_BUDGET} (${stack_pct})")
+if(EXISTS ${BASELINE} AND NOT base_flash STREQUAL "")
+    math(EXPR flash_delta "${flash} - ${base_flash}")
+    math(EXPR ram_delta "${ram} - ${base_ram}")
+    math(EXPR stack_delta "${stack} - ${base_stack}")
+    signed(flash_delta ${flash_delta})
+    signed(ram_delta ${ram_delta})
+    signed(stack_delta ${stack_delta})
+    message(STATUS "${NAME}: against baseline flash ${flash_delta} ram ${ram_delta} stack ${stack_delta}\n${diff}")
+else()
+    message(STATUS "${NAME}: no baseline at ${BASELINE}")
+endif()
+
+set(failed "")
+if(flash GREATER FLASH_BUDGET)
+    list(APPEND failed "flash")
+endif()
+if(ram GREATER RAM_BUDGET)
+    list(APPEND failed "ram")
+endif()
+if(stack GREATER STACK_BUDGET)
+    list(APPEND failed "stack")
+endif()
+if(NOT DEFINED frame_main)
+    message(WARNING "${NAME}: main not found in the call graph under ${CALLGRAPH_DIR}")
+elseif(DEFINED unbounded_main)
+    message(WARNING "${NAME}: stack depth of main is not bounded (${unbounded_main})")
+endif()
+if(failed)
+    message(FATAL_ERROR "${NAME}: over budget (${failed}), see ${OUTPUT}")
+endif()
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <string>
 
 struct BoardConfig {
@@ -19,6 +21,7 @@ struct BoardConfig {
         public:
             static constexpr auto name{"Temperature"};
             static constexpr auto address{0x44};
+            static constexpr auto warmUpTime{std::chrono::milliseconds(2)};
             static constexpr auto canAddressTemp{canBaseAddress + canBlockOffsetTemp};
             static constexpr auto canAddressAbsoluteHumid{
               canBaseAddress + canBlockOffsetAbsoluteHumid};
@@ -33,6 +36,8 @@ struct BoardConfig {
         public:
             static constexpr auto name{"AirQuality"};
             static constexpr auto address{0x58};
+            // after power up the SGP30 reports fixed values until its baseline init is done
+            static constexpr auto warmUpTime{std::chrono::milliseconds(15'000)};
             static constexpr auto canAddressVOC{canBaseAddress + canBlockOffsetVOC};
             static constexpr auto canAddressCO2Eq{canBaseAddress + canBlockOffsetCO2Eq};
         };
@@ -43,6 +48,7 @@ struct BoardConfig {
         public:
             static constexpr auto name{"Pressure"};
             static constexpr auto address{0x77};
+            static constexpr auto warmUpTime{std::chrono::milliseconds(3)};
             static constexpr auto canAddress{canBaseAddress + canBlockAddress};
         };
         struct Light {
@@ -52,7 +58,34 @@ struct BoardConfig {
         public:
             static constexpr auto name{"Light"};
             static constexpr auto address{0x23};
+            static constexpr auto warmUpTime{std::chrono::milliseconds(180)};
             static constexpr auto canAddress{canBaseAddress + canBlockAddress};
         };
     };
+    struct Supervisor {
+    private:
+        static constexpr auto canBlockAddress{7};
+
+    public:
+        // one message per task with the worst check in gap of the previous run
+        static constexpr auto canAddress{canBaseAddress + canBlockAddress};
+        // watchdog runs in window mode, 512ms closed and 2048ms open
+        static constexpr auto feedInterval{std::chrono::milliseconds(1'000)};
+        // the I2C power manager power cycles the sensors after bus errors, reading the sensors
+        // waits for the same recovery
+        static constexpr auto sensorDeadline{std::chrono::milliseconds(10'000)};
+    };
+    struct LowPower {
+        // report once per sampleInterval and idle in between, for battery backed incubators
+        static constexpr auto enabled{false};
+        static constexpr auto sampleInterval{std::chrono::milliseconds(60'000)};
+        // time after warm up in which sensor values are read and sent over CAN
+        static constexpr auto sampleWindow{std::chrono::milliseconds(2'000)};
+        // the slowest sensor decides when values of all sensors are valid after boot
+        static constexpr auto warmUpTime{std::max(
+          {Sensors::Temperature::warmUpTime,
+           Sensors::AirQuality::warmUpTime,
+           Sensors::Pressure::warmUpTime,
+           Sensors::Light::warmUpTime})};
+    };
 };
@@ -3,9 +3,10 @@
 //
 #pragma once
 #include "BoardConfig.hpp"
-#include "Watchdog.hpp"
 
 #include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <optional>
 
 template<typename CAN, typename Clock>
@@ -19,7 +20,7 @@ struct CANCommunicator {
     std::optional<std::uint32_t> Light;
     std::optional<float>         AirPressure;
 
-    bool          busy_;
+    bool          busy_{false};
     tp            waitTime_;
     std::uint32_t errorCounter{0};
 
@@ -40,6 +41,16 @@ struct CANCommunicator {
 
     State st_ = State::reset;
 
+    template<typename T>
+    static Kvasir::CAN::CanMessage packCanMessage(T value, std::uint32_t identifier) {
+        constexpr size_t        dataSize = sizeof(value);
+        Kvasir::CAN::CanMessage msg;
+        msg.setId(identifier);
+        msg.setSize(dataSize);
+        std::memcpy(&msg.data, &value, dataSize);
+        return msg;
+    }
+
     void handler() {
         auto const currentTime = Clock::now();
         if(errorCounter > 1000) {
@@ -47,15 +58,6 @@ struct CANCommunicator {
             KL_E("can is not working... shutting can down!");
         }
 
-        auto packCanMessage = [](auto value, std::uint32_t identifier) {
-            constexpr size_t         dataSize = sizeof(value);
-            Kvasir::CAN::CanMessage msg;
-            msg.setId(identifier);
-            msg.setSize(dataSize);
-            std::memcpy(&msg.data, &value, dataSize);
-            return msg;
-        };
-
         switch(st_) {
         case State::reset:
             {
@@ -75,7 +77,6 @@ struct CANCommunicator {
             {
                 busy_        = false;
                 errorCounter = 0;
-                WDReset{}();
                 if(currentTime > waitTime_) {
                     st_   = State::sendTemperature;
                     busy_ = true;
@@ -90,7 +91,7 @@ struct CANCommunicator {
                     auto msg = packCanMessage(
                       Temperature.value(),
                       BoardConfig::Sensors::Temperature::canAddressTemp);
-                    if(!Can::send(msg)) {
+                    if(!CAN::send(msg)) {
                         st_ = State::sendTemperature;
                         ++errorCounter;
                         KL_W("Could not send temperature");
@@ -106,7 +107,7 @@ struct CANCommunicator {
                     auto msg = packCanMessage(
                       RelativeHumidity.value(),
                       BoardConfig::Sensors::Temperature::canAddressRelativeHumid);
-                    if(!Can::send(msg)) {
+                    if(!CAN::send(msg)) {
                         st_ = State::sendRelHumidity;
                         KL_W("Could not send relative humidity");
                     }
@@ -120,7 +121,7 @@ struct CANCommunicator {
                     auto msg = packCanMessage(
                       AbsoluteHumidity.value(),
                       BoardConfig::Sensors::Temperature::canAddressAbsoluteHumid);
-                    if(!Can::send(msg)) {
+                    if(!CAN::send(msg)) {
                         st_ = State::sendAbsHumidity;
                         ++errorCounter;
                         KL_W("Could not send absolute humidity");
@@ -136,7 +137,7 @@ struct CANCommunicator {
                     auto msg = packCanMessage(
                             AirQualityVOC.value(),
                             BoardConfig::Sensors::AirQuality::canAddressVOC);
-                    if(!Can::send(msg)) {
+                    if(!CAN::send(msg)) {
                         st_ = State::sendAQVOC;
                         ++errorCounter;
                         KL_W("Could not send VOC");
@@ -152,7 +153,7 @@ struct CANCommunicator {
                     auto msg = packCanMessage(
                             AirQualityCO2.value(),
                             BoardConfig::Sensors::AirQuality::canAddressCO2Eq);
-                    if(!Can::send(msg)) {
+                    if(!CAN::send(msg)) {
                         st_ = State::sendAQCO2;
                         ++errorCounter;
                         KL_W("Could not send CO2");
@@ -168,7 +169,7 @@ struct CANCommunicator {
                     auto msg = packCanMessage(
                             Light.value(),
                             BoardConfig::Sensors::Light::canAddress);
-                    if(!Can::send(msg)) {
+                    if(!CAN::send(msg)) {
                         st_ = State::sendLight;
                         ++errorCounter;
                         KL_W("Could not send light");
@@ -184,7 +185,7 @@ struct CANCommunicator {
                     auto msg = packCanMessage(
                             AirPressure.value(),
                             BoardConfig::Sensors::Pressure::canAddress);
-                    if(!Can::send(msg)) {
+                    if(!CAN::send(msg)) {
                         st_ = State::sendAirPressure;
                         ++errorCounter;
                         KL_W("Could not send air pressure");
@@ -127,6 +127,21 @@ struct ClockSettings {
     }
 };
 
+// IDLE sleep keeps the DPLL and the systick running so Clock stays valid, the core wakes
+// on the next interrupt: CAN rx or the systick overflow at the latest, which bounds the
+// added latency of a state change to one systick period (2^24 / ClockSpeed ~ 350ms).
+// STANDBY would stop the systick and needs an RTC based clock.
+struct Sleep {
+    static void init() {
+        using PM = Kvasir::Peripheral::PM::Registers<>;
+        apply(write(PM::SLEEPCFG::SLEEPMODEValC::idle));
+        // the write passes the bus bridge, wfi before it arrived uses the old mode
+        while(apply(read(PM::SLEEPCFG::sleepmode)) != PM::SLEEPCFG::SLEEPMODEVal::idle) {
+        }
+    }
+    static void sleep() { asm volatile("wfi"); }
+};
+
 //TODO Configure Busses and IO
 struct I2CConfig {
     static constexpr auto clockSpeed = ClockSpeed;
@@ -0,0 +1,112 @@
+#pragma once
+#include "BoardConfig.hpp"
+#include "kvasir/Util/log.hpp"
+
+#include <chrono>
+#include <cstdint>
+
+// Low power acquisition: sensor values are only reported in one sample window per
+// sampleInterval and the core idles while nothing has to be done. The sensor rail stays
+// powered, the first window after boot waits for the slowest sensor to warm up.
+//
+// Sleep needs a static sleep() that returns on the next interrupt.
+template<typename Clock, typename Sleep, typename Config = BoardConfig::LowPower>
+struct LowPowerAcquisition {
+    using tp       = typename Clock::time_point;
+    using duration = typename Clock::duration;
+
+    enum class State : std::uint8_t { reset, waiting, warmUp, sampling };
+
+    State    st_ = State::reset;
+    tp       waitTime_;
+    tp       cycleStart_;
+    bool     sampled_{false};
+    duration latency_{};
+    duration sleepTime_{};
+
+    void handler() {
+        auto const currentTime = Clock::now();
+        switch(st_) {
+        case State::reset:
+            {
+                startCycle(currentTime);
+                st_       = State::warmUp;
+                waitTime_ = currentTime + Config::warmUpTime;
+            }
+            break;
+        case State::waiting:
+            {
+                if(currentTime >= waitTime_) {
+                    report(currentTime);
+                    // the wake up is noticed up to one sleep late, the cycles stay on their grid
+                    startCycle(waitTime_);
+                    startWindow(waitTime_);
+                }
+            }
+            break;
+        case State::warmUp:
+            {
+                if(currentTime >= waitTime_) {
+                    startWindow(waitTime_);
+                }
+            }
+            break;
+        case State::sampling:
+            {
+                if(currentTime >= waitTime_) {
+                    st_       = State::waiting;
+                    waitTime_ = cycleStart_ + Config::sampleInterval;
+                }
+            }
+            break;
+        }
+    }
+
+    // sensor values are valid and should be reported
+    bool sampling() const { return st_ == State::sampling; }
+
+    // nothing happens before the next state change, the core may idle
+    bool idle() const { return st_ == State::waiting || st_ == State::warmUp; }
+
+    // called once fresh values of all sensors are present in the current window, the latency
+    // is counted from the start of the cycle
+    void sampled() {
+        if(sampling() && !sampled_) {
+            sampled_ = true;
+            latency_ = Clock::now() - cycleStart_;
+        }
+    }
+
+    void sleep() {
+        if(idle()) {
+            auto const before = Clock::now();
+            Sleep::sleep();
+            sleepTime_ += Clock::now() - before;
+        }
+    }
+
+private:
+    void startCycle(tp start) {
+        cycleStart_ = start;
+        sleepTime_  = {};
+        sampled_    = false;
+    }
+
+    void startWindow(tp start) {
+        st_       = State::sampling;
+        waitTime_ = start + Config::sampleWindow;
+    }
+
+    // average current ~ awake * I_active + (1 - awake) * I_idle
+    void report(tp currentTime) const {
+        using std::chrono::duration_cast;
+        using std::chrono::milliseconds;
+        auto const cycle = duration_cast<milliseconds>(currentTime - cycleStart_).count();
+        auto const awake = cycle - duration_cast<milliseconds>(sleepTime_).count();
+        KL_I(
+          "low power: cycle {}ms awake {}ms sample latency {}ms",
+          cycle,
+          awake,
+          sampled_ ? duration_cast<milliseconds>(latency_).count() : -1);
+    }
+};
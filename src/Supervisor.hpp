@@ -0,0 +1,182 @@
+#pragma once
+#include "BoardConfig.hpp"
+#include "kvasir/Util/log.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+enum class Task : std::uint8_t { sensors, can, bootloader, i2c, loop, count };
+
+static constexpr std::size_t TaskCount{static_cast<std::size_t>(Task::count)};
+
+// lives in .noinit and survives the watchdog reset, reported at the next boot
+struct SupervisorRecord {
+    static constexpr std::uint32_t validMagic{0x5355'5056};
+
+    std::uint32_t                        magic;
+    Task                                 running;
+    Task                                 late;
+    std::array<std::uint32_t, TaskCount> worstGapMs;
+    std::uint32_t                        check;
+
+    std::uint32_t checksum() const {
+        std::uint32_t sum = magic ^ (std::uint32_t(running) << 8) ^ std::uint32_t(late);
+        for(auto gap : worstGapMs) {
+            sum = (sum << 1 | sum >> 31) ^ gap;
+        }
+        return ~sum;
+    }
+    bool valid() const { return magic == validMagic && check == checksum(); }
+    void seal() { check = checksum(); }
+};
+static_assert(sizeof(SupervisorRecord) <= 64, "does not fit the noinit region, see linker/app.ld.in");
+
+// Every main loop task has to check in within its deadline, the watchdog is only fed while
+// all tasks are healthy. The task running or late when the watchdog bites is kept in the
+// record together with the worst check in gap of every task. handler() itself runs as
+// Task::loop.
+template<typename Clock, typename CAN, typename WD>
+struct Supervisor {
+    using tp = typename Clock::time_point;
+
+    static constexpr std::array<std::chrono::milliseconds, TaskCount> deadlines{
+      BoardConfig::Supervisor::sensorDeadline,   // sensors
+      std::chrono::milliseconds(500),            // can, handler called every pass
+      std::chrono::milliseconds(500),            // bootloader, polled every pass, one idle sleep
+      BoardConfig::Supervisor::sensorDeadline,   // i2c
+      std::chrono::milliseconds(500)};           // loop, the rest of the main loop
+
+    SupervisorRecord&         record_;
+    SupervisorRecord          previous_;
+    bool                      previousValid_;
+    bool                      watchdogReset_;
+    std::size_t               reportIndex_{0};
+    std::array<tp, TaskCount> lastCheckIn_;
+    tp                        nextFeed_;
+    bool                      healthy_{true};
+
+    explicit Supervisor(SupervisorRecord& record)
+      : record_{record}
+      , previous_{record}
+      , previousValid_{record.valid()}
+      , watchdogReset_{WD::causedReset()} {
+        auto const currentTime = Clock::now();
+        lastCheckIn_.fill(currentTime);
+        nextFeed_ = currentTime + BoardConfig::Supervisor::feedInterval;
+
+        record_.magic   = SupervisorRecord::validMagic;
+        record_.running = Task::count;
+        record_.late    = Task::count;
+        record_.worstGapMs.fill(0);
+        record_.seal();
+
+        if(previousValid_ && watchdogReset_) {
+            KL_E("watchdog reset, running task {} late task {}",
+                 static_cast<std::uint8_t>(previous_.running),
+                 static_cast<std::uint8_t>(previous_.late));
+        }
+        WD{}.enableWindowed();
+    }
+
+    // f returns true if the task made progress, a task that returned without work to do counts
+    template<typename F>
+    void run(Task task, F&& f) {
+        record_.running = task;
+        record_.seal();
+        bool const progress = f();
+        record_.running = Task::count;
+        if(progress) {
+            checkIn(task, Clock::now());
+        }
+        record_.seal();
+    }
+
+    void handler() {
+        record_.running = Task::loop;
+        record_.seal();
+        auto const currentTime = Clock::now();
+
+        bool healthy = true;
+        Task late    = Task::count;
+        for(std::size_t i = 0; i < TaskCount; ++i) {
+            updateWorstGap(i, currentTime);
+            if(currentTime - lastCheckIn_[i] > deadlines[i]) {
+                healthy = false;
+                late    = static_cast<Task>(i);
+            }
+        }
+        record_.late = late;
+
+        if(!healthy && healthy_) {
+            KL_E("task {} missed its deadline", static_cast<std::uint8_t>(record_.late));
+        }
+        healthy_ = healthy;
+
+        if(healthy && currentTime >= nextFeed_) {
+            WD{}();
+            nextFeed_ = currentTime + BoardConfig::Supervisor::feedInterval;
+        }
+
+        sendReport();
+        record_.running = Task::count;
+        record_.seal();
+    }
+
+private:
+    struct ReportMessage {
+        std::uint8_t  task;
+        std::uint8_t  flags;
+        std::uint16_t deadlineMs;
+        std::uint32_t worstGapMs;
+    };
+    static_assert(sizeof(ReportMessage) == 8);
+
+    enum ReportFlags : std::uint8_t { watchdogReset = 1, wasRunning = 2, wasLate = 4 };
+
+    void updateWorstGap(std::size_t i, tp currentTime) {
+        auto const gap = static_cast<std::uint32_t>(
+          std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - lastCheckIn_[i])
+            .count());
+        if(gap > record_.worstGapMs[i]) {
+            record_.worstGapMs[i] = gap;
+        }
+    }
+
+    void checkIn(Task task, tp currentTime) {
+        auto const i = static_cast<std::size_t>(task);
+        updateWorstGap(i, currentTime);
+        lastCheckIn_[i] = currentTime;
+    }
+
+    void sendReport() {
+        if(!previousValid_ || reportIndex_ >= TaskCount) {
+            return;
+        }
+        auto const   task = static_cast<Task>(reportIndex_);
+        std::uint8_t flags{};
+        if(watchdogReset_) {
+            flags |= ReportFlags::watchdogReset;
+            if(previous_.running == task) {
+                flags |= ReportFlags::wasRunning;
+            }
+            if(previous_.late == task) {
+                flags |= ReportFlags::wasLate;
+            }
+        }
+        ReportMessage const report{
+          static_cast<std::uint8_t>(task),
+          flags,
+          static_cast<std::uint16_t>(deadlines[reportIndex_].count()),
+          previous_.worstGapMs[reportIndex_]};
+
+        Kvasir::CAN::CanMessage msg;
+        msg.setId(BoardConfig::Supervisor::canAddress);
+        msg.setSize(sizeof(report));
+        std::memcpy(&msg.data, &report, sizeof(report));
+        if(CAN::send(msg)) {
+            ++reportIndex_;
+        }
+    }
+};
@@ -8,7 +8,22 @@ struct WDReset {
     void enable(){
         apply(set(Kvasir::Peripheral::WDT::Registers<>::CTRLA::enable));
     }
+    // feeding in the first 512ms after the last feed resets as well as not feeding for 2560ms
+    void enableWindowed() {
+        using WDT = Kvasir::Peripheral::WDT::Registers<>;
+        apply(clear(WDT::CTRLA::enable));
+        while(apply(read(WDT::SYNCBUSY::enable))) {
+        }
+        apply(write(WDT::CONFIG::WINDOWValC::cyc512), write(WDT::CONFIG::PERValC::cyc2048));
+        // wen and enable are write synchronized, both go in one CTRLA write
+        apply(set(WDT::CTRLA::wen), set(WDT::CTRLA::enable));
+        while(apply(read(WDT::SYNCBUSY::wen)) || apply(read(WDT::SYNCBUSY::enable))) {
+        }
+    }
     void operator()() const {
         apply(write(Kvasir::Peripheral::WDT::Registers<>::CLEAR::CLEARValC::key));
     }
+    static bool causedReset() {
+        return apply(read(Kvasir::Peripheral::RSTC::Registers<>::RCAUSE::wdt));
+    }
 };
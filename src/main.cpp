@@ -27,8 +27,12 @@ using Startup
 #include "aglio/packager.hpp"
 #include "aglio/serializer.hpp"
 #include "kvasir/Util/AppBootloader.hpp"
+#include "LowPower.hpp"
+#include "Supervisor.hpp"
 #include "Watchdog.hpp"
 
+#include <optional>
+
 
 template<typename Can>
 struct AppBootloaderPart {
@@ -58,10 +62,12 @@ struct AppBootloaderPart {
 };
 
 
+[[gnu::section(".noinit")]] static SupervisorRecord supervisorRecord;
+
 int main() {
     KL_I("{}", Kvasir::Version::FullVersion);
     WDReset{}();
-    WDReset{}.enable();
+    Supervisor<Clock, Can, WDReset> supervisor{supervisorRecord};
     AppBootloaderPart<Can> bootloader;
 
     auto next1s  = Clock::now();
@@ -71,7 +77,11 @@ int main() {
     Kvasir::BMP384<I2C, Clock> PressureSensor{0x77}; //Address in DEC: 119
     Kvasir::BH1751<I2C, Clock> LightSensor{0x23}; //Address in DEC: 35
     CANCommunicator<Can, Clock> canCommunicator;
+    LowPowerAcquisition<Clock, HW::Sleep> acquisition;
 
+    if constexpr(BoardConfig::LowPower::enabled) {
+        HW::Sleep::init();
+    }
 
     auto i2cPowerManager{Kvasir::make_I2CPowerManager<I2C, Clock, HW::Pin::sw_vdd, true>(
       TemperatureSensor,
@@ -80,42 +90,106 @@ int main() {
       PressureSensor)};
 
     while(true) {
-        std::optional<float> CurrentTemperature{TemperatureSensor.t()};
-        std::optional<float> CurrentRelativeHumidity{TemperatureSensor.rh()};
-        std::optional<float> CurrentAbsoluteHumidity{TemperatureSensor.ah()};
-        std::optional<float> CurrentLight{LightSensor.lux()};
-        std::optional<float> CurrentAirPressure{PressureSensor.p()};
-
-        if(Clock::now() >= next1s) {
-            next1s = Clock::now() + 1s;
-            KL_T(
-              "Temp:{:.1f} HumidRel:{:.1f} HumidAbs:{:.1f} VOC:{} CO2Eq:{} Light:{} Pressure:{:.1f} {:.1f}",
-              TemperatureSensor.t(),
-              TemperatureSensor.rh(),
-              TemperatureSensor.ah(),
-              AirQualitySensor.vocraw_,
-              AirQualitySensor.co2eqraw_,
-              LightSensor.luxraw_,
-              PressureSensor.p(),
-              PressureSensor.t());
-        }
+        // progress: every pass, a hang in the low power state machine or the sensor power up
+        // is recorded here
+        supervisor.run(Task::loop, [&] {
+            if constexpr(BoardConfig::LowPower::enabled) {
+                acquisition.handler();
+            }
+            return true;
+        });
+
+        // progress: the sensor values reached the CAN communicator, or there was nothing to
+        // report outside the sample window; unchanged or missing values are no hang
+        supervisor.run(Task::sensors, [&] {
+            if(BoardConfig::LowPower::enabled && !acquisition.sampling()) {
+                canCommunicator.update({}, {}, {}, {}, {}, {}, {});
+                return true;
+            }
 
-        canCommunicator.update(CurrentTemperature,
-                               CurrentRelativeHumidity,
-                               CurrentAbsoluteHumidity,
-                               AirQualitySensor.vocraw_,
-                               AirQualitySensor.co2eqraw_,
-                               CurrentLight,
-                               CurrentAirPressure);
+            std::optional<float>         CurrentTemperature{TemperatureSensor.t()};
+            std::optional<float>         CurrentRelativeHumidity{TemperatureSensor.rh()};
+            std::optional<float>         CurrentAbsoluteHumidity{TemperatureSensor.ah()};
+            std::optional<std::uint32_t> CurrentAirQualityVOC;
+            std::optional<std::uint32_t> CurrentAirQualityCO2;
+            std::optional<float>         CurrentLight{LightSensor.lux()};
+            std::optional<float>         CurrentAirPressure{PressureSensor.p()};
+            // CO2eq never reads below 400ppm, 0 means the SGP30 has not measured yet
+            if(AirQualitySensor.co2eqraw_ != 0) {
+                CurrentAirQualityVOC = AirQualitySensor.vocraw_;
+                CurrentAirQualityCO2 = AirQualitySensor.co2eqraw_;
+            }
+
+            if constexpr(BoardConfig::LowPower::enabled) {
+                if(CurrentTemperature && CurrentRelativeHumidity && CurrentAbsoluteHumidity
+                   && CurrentAirQualityVOC && CurrentAirQualityCO2 && CurrentLight
+                   && CurrentAirPressure)
+                {
+                    acquisition.sampled();
+                }
+            }
 
-        canCommunicator.handler();
+            canCommunicator.update(
+              CurrentTemperature,
+              CurrentRelativeHumidity,
+              CurrentAbsoluteHumidity,
+              CurrentAirQualityVOC,
+              CurrentAirQualityCO2,
+              CurrentLight,
+              CurrentAirPressure);
+            return true;
+        });
+
+        // progress: the handler returned, a failed send counts as well and ends in the error
+        // state after 1000 tries like before
+        supervisor.run(Task::can, [&] {
+            canCommunicator.handler();
+            return true;
+        });
+
+        // progress: the receive queue was polled, the bootloader part only works on messages
+        // and a handler that never returns is recorded as the running task
         //Goes 0...70
-        if(auto msg = Can::recv(); msg) {
-            bootloader.handler(*msg);
+        supervisor.run(Task::bootloader, [&] {
+            if(auto msg = Can::recv(); msg) {
+                bootloader.handler(*msg);
+            }
+            return true;
+        });
+
+        // progress: the power manager handler returned, a failed transfer is its to recover
+        supervisor.run(Task::i2c, [&] {
+            i2cPowerManager.handler();
+            return true;
+        });
+
+        supervisor.run(Task::loop, [&] {
+            if(Clock::now() >= next1s) {
+                next1s = Clock::now() + 1s;
+                KL_T(
+                  "Temp:{:.1f} HumidRel:{:.1f} HumidAbs:{:.1f} VOC:{} CO2Eq:{} Light:{} Pressure:{:.1f} {:.1f}",
+                  TemperatureSensor.t(),
+                  TemperatureSensor.rh(),
+                  TemperatureSensor.ah(),
+                  AirQualitySensor.vocraw_,
+                  AirQualitySensor.co2eqraw_,
+                  LightSensor.luxraw_,
+                  PressureSensor.p(),
+                  PressureSensor.t());
+            }
+            StackProtector::handler();
+            return true;
+        });
+        supervisor.handler();
+
+        if constexpr(BoardConfig::LowPower::enabled) {
+            supervisor.run(Task::loop, [&] {
+                if(!canCommunicator.busy_) {
+                    acquisition.sleep();
+                }
+                return true;
+            });
         }
-
-        i2cPowerManager.handler();
-        StackProtector::handler();
     }
 }
 
@@ -0,0 +1,121 @@
+#include "HostStubs.hpp"
+//
+#include "LowPower.hpp"
+
+#include <gtest/gtest.h>
+
+namespace {
+struct FakeSleep {
+    static inline std::size_t sleeps{0};
+    static void               sleep() { ++sleeps; }
+};
+
+struct TestConfig {
+    static constexpr auto sampleInterval{std::chrono::milliseconds(10'000)};
+    static constexpr auto sampleWindow{std::chrono::milliseconds(1'000)};
+    static constexpr auto warmUpTime{std::chrono::milliseconds(2'000)};
+};
+
+struct LowPowerTest : ::testing::Test {
+    using Acquisition = LowPowerAcquisition<ManualClock, FakeSleep, TestConfig>;
+    using State       = Acquisition::State;
+
+    Acquisition acquisition;
+
+    void SetUp() override {
+        ManualClock::current = ManualClock::time_point{};
+        FakeSleep::sleeps    = 0;
+    }
+
+    void step(std::chrono::milliseconds d) {
+        ManualClock::advance(d);
+        acquisition.handler();
+    }
+};
+}   // namespace
+
+TEST_F(LowPowerTest, cycleThroughAllStates) {
+    using std::chrono::milliseconds;
+    EXPECT_EQ(acquisition.st_, State::reset);
+
+    acquisition.handler();
+    EXPECT_EQ(acquisition.st_, State::warmUp);
+    EXPECT_FALSE(acquisition.sampling());
+
+    step(milliseconds(1'999));
+    EXPECT_EQ(acquisition.st_, State::warmUp);
+    step(milliseconds(1));
+    EXPECT_EQ(acquisition.st_, State::sampling);
+    EXPECT_TRUE(acquisition.sampling());
+
+    step(milliseconds(1'000));
+    EXPECT_EQ(acquisition.st_, State::waiting);
+    EXPECT_FALSE(acquisition.sampling());
+
+    // next cycle starts sampleInterval after the last one and skips the warm up
+    step(milliseconds(6'999));
+    EXPECT_EQ(acquisition.st_, State::waiting);
+    step(milliseconds(1));
+    EXPECT_EQ(acquisition.st_, State::sampling);
+}
+
+TEST_F(LowPowerTest, latencyCountsFromCycleStart) {
+    using std::chrono::milliseconds;
+    acquisition.handler();
+    acquisition.sampled();
+    EXPECT_FALSE(acquisition.sampled_);
+
+    step(milliseconds(2'000));
+    ManualClock::advance(milliseconds(250));
+    acquisition.sampled();
+    EXPECT_TRUE(acquisition.sampled_);
+    EXPECT_EQ(acquisition.latency_, milliseconds(2'250));
+
+    // only the first complete sample of a window counts
+    ManualClock::advance(milliseconds(100));
+    acquisition.sampled();
+    EXPECT_EQ(acquisition.latency_, milliseconds(2'250));
+
+    step(milliseconds(650));
+    step(milliseconds(7'000));
+    EXPECT_FALSE(acquisition.sampled_);
+}
+
+TEST_F(LowPowerTest, cyclesStayOnTheirGridWhenWokenLate) {
+    using std::chrono::milliseconds;
+    acquisition.handler();
+    step(milliseconds(2'000));
+    step(milliseconds(1'000));
+
+    // every wake up is noticed 300ms after the cycle was due
+    for(int cycle = 1; cycle <= 5; ++cycle) {
+        ManualClock::current = ManualClock::time_point{milliseconds(cycle * 10'000 + 300)};
+        acquisition.handler();
+        EXPECT_EQ(acquisition.cycleStart_.time_since_epoch(), milliseconds(cycle * 10'000));
+        EXPECT_EQ(acquisition.waitTime_.time_since_epoch(), milliseconds(cycle * 10'000 + 1'000));
+        step(milliseconds(700));
+        EXPECT_EQ(acquisition.st_, State::waiting);
+    }
+}
+
+TEST_F(LowPowerTest, sleepsOnlyWhileIdle) {
+    using std::chrono::milliseconds;
+    acquisition.handler();
+    acquisition.sleep();
+    EXPECT_EQ(FakeSleep::sleeps, 1u);
+
+    step(milliseconds(2'000));
+    acquisition.sleep();
+    EXPECT_EQ(FakeSleep::sleeps, 1u);
+
+    step(milliseconds(1'000));
+    acquisition.sleep();
+    EXPECT_EQ(FakeSleep::sleeps, 2u);
+}
+
+TEST(LowPowerBoardConfig, firstWindowWaitsForTheSlowestSensor) {
+    EXPECT_EQ(BoardConfig::LowPower::warmUpTime, BoardConfig::Sensors::AirQuality::warmUpTime);
+    EXPECT_GT(
+      BoardConfig::LowPower::sampleInterval,
+      BoardConfig::LowPower::warmUpTime + BoardConfig::LowPower::sampleWindow);
+}
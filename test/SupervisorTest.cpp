@@ -0,0 +1,129 @@
+#include "HostStubs.hpp"
+//
+#include "CANCommunicator.hpp"
+#include "Supervisor.hpp"
+
+#include <gtest/gtest.h>
+
+namespace {
+struct FakeWatchdog {
+    static inline std::size_t feeds{0};
+    static inline bool        windowed{false};
+    static inline bool        bit{false};
+
+    void        operator()() const { ++feeds; }
+    void        enableWindowed() { windowed = true; }
+    static bool causedReset() { return bit; }
+};
+
+using TestSupervisor = Supervisor<ManualClock, StubCan, FakeWatchdog>;
+
+struct SupervisorTest : ::testing::Test {
+    SupervisorRecord record{};
+
+    void SetUp() override {
+        ManualClock::current = {};
+        FakeWatchdog::feeds  = 0;
+        FakeWatchdog::bit    = false;
+        StubCan::sent        = 0;
+    }
+
+    static void checkInAll(TestSupervisor& supervisor, Task skip = Task::count) {
+        for(std::size_t i = 0; i < TaskCount; ++i) {
+            auto const task = static_cast<Task>(i);
+            supervisor.run(task, [&] { return task != skip; });
+        }
+    }
+};
+}   // namespace
+
+TEST_F(SupervisorTest, feedsWhileAllTasksProgress) {
+    TestSupervisor supervisor{record};
+    EXPECT_TRUE(FakeWatchdog::windowed);
+    for(int i = 0; i < 10; ++i) {
+        ManualClock::advance(std::chrono::milliseconds(400));
+        checkInAll(supervisor);
+        supervisor.handler();
+    }
+    EXPECT_EQ(FakeWatchdog::feeds, 3u);
+    EXPECT_EQ(record.late, Task::count);
+    EXPECT_TRUE(record.valid());
+}
+
+TEST_F(SupervisorTest, stopsFeedingWhenATaskMakesNoProgress) {
+    TestSupervisor supervisor{record};
+    for(int i = 0; i < 10; ++i) {
+        ManualClock::advance(std::chrono::milliseconds(400));
+        checkInAll(supervisor, Task::bootloader);
+        supervisor.handler();
+    }
+    EXPECT_EQ(record.late, Task::bootloader);
+    EXPECT_EQ(record.worstGapMs[static_cast<std::size_t>(Task::bootloader)], 4'000u);
+    EXPECT_TRUE(record.valid());
+    auto const feeds = FakeWatchdog::feeds;
+    ManualClock::advance(std::chrono::milliseconds(2'000));
+    supervisor.handler();
+    EXPECT_EQ(FakeWatchdog::feeds, feeds);
+}
+
+TEST_F(SupervisorTest, reportsThePreviousRecordAfterAWatchdogReset) {
+    record.magic   = SupervisorRecord::validMagic;
+    record.running = Task::i2c;
+    record.late    = Task::sensors;
+    record.worstGapMs.fill(0);
+    record.worstGapMs[static_cast<std::size_t>(Task::i2c)] = 12'345;
+    record.seal();
+    FakeWatchdog::bit = true;
+
+    TestSupervisor supervisor{record};
+    for(std::size_t i = 0; i < TaskCount; ++i) {
+        checkInAll(supervisor);
+        supervisor.handler();
+        if(i == static_cast<std::size_t>(Task::i2c)) {
+            EXPECT_EQ(StubCan::last.data[0], std::byte{static_cast<std::uint8_t>(Task::i2c)});
+            EXPECT_EQ(StubCan::last.data[1], std::byte{1 | 2});
+        }
+    }
+    EXPECT_EQ(StubCan::sent, TaskCount);
+    supervisor.handler();
+    EXPECT_EQ(StubCan::sent, TaskCount);
+    EXPECT_EQ(record.running, Task::count);
+}
+
+TEST_F(SupervisorTest, feedsWhileSensorReadingsNeverChange) {
+    // sensor board unplugged: every reading stays empty, the node has to keep running
+    TestSupervisor                        supervisor{record};
+    CANCommunicator<StubCan, ManualClock> canCommunicator;
+    std::optional<float> const            missing{};
+    std::optional<std::uint32_t> const    missingRaw{};
+    std::size_t                           i2cPasses{0};
+    for(int i = 0; i < 6'000; ++i) {
+        ManualClock::advance(std::chrono::milliseconds(10));
+        supervisor.run(Task::loop, [] { return true; });
+        supervisor.run(Task::sensors, [&] {
+            canCommunicator.update(missing, missing, missing, missingRaw, missingRaw, missing, missing);
+            return true;
+        });
+        supervisor.run(Task::can, [&] {
+            canCommunicator.handler();
+            return true;
+        });
+        supervisor.run(Task::bootloader, [] { return true; });
+        supervisor.run(Task::i2c, [&] {
+            ++i2cPasses;
+            return true;
+        });
+        supervisor.handler();
+    }
+    EXPECT_EQ(i2cPasses, 6'000u);
+    EXPECT_EQ(FakeWatchdog::feeds, 60u);
+    EXPECT_EQ(record.late, Task::count);
+    EXPECT_EQ(record.running, Task::count);
+    EXPECT_TRUE(record.valid());
+}
+
+TEST_F(SupervisorTest, sensorsAndI2cShareTheRecoveryAllowance) {
+    EXPECT_EQ(
+      TestSupervisor::deadlines[static_cast<std::size_t>(Task::sensors)],
+      TestSupervisor::deadlines[static_cast<std::size_t>(Task::i2c)]);
+}
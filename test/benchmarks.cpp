@@ -0,0 +1,57 @@
+#include "HostStubs.hpp"
+//
+#include "CANCommunicator.hpp"
+
+#include <benchmark/benchmark.h>
+
+using Communicator = CANCommunicator<StubCan, ManualClock>;
+
+static void packCanMessageFloat(benchmark::State& state) {
+    float value{23.5f};
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(value);
+        auto msg = Communicator::packCanMessage(value, BoardConfig::Sensors::Temperature::canAddressTemp);
+        benchmark::DoNotOptimize(msg);
+    }
+}
+BENCHMARK(packCanMessageFloat);
+
+static void packCanMessageU32(benchmark::State& state) {
+    std::uint32_t value{400};
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(value);
+        auto msg = Communicator::packCanMessage(value, BoardConfig::Sensors::AirQuality::canAddressCO2Eq);
+        benchmark::DoNotOptimize(msg);
+    }
+}
+BENCHMARK(packCanMessageU32);
+
+// one handler() call in idle, the state the main loop spends nearly all its passes in
+static void handlerIdle(benchmark::State& state) {
+    Communicator communicator{};
+    communicator.handler();
+    communicator.waitTime_ = ManualClock::now() + std::chrono::hours(1);
+    for(auto _ : state) {
+        communicator.handler();
+        benchmark::DoNotOptimize(communicator.st_);
+    }
+}
+BENCHMARK(handlerIdle);
+
+// a full send cycle, idle over all seven sensor messages back to idle
+static void handlerSendCycle(benchmark::State& state) {
+    Communicator communicator{};
+    communicator.handler();
+    communicator.update(21.5f, 45.0f, 8.6f, 12u, 400u, 120.0f, 1013.25f);
+    for(auto _ : state) {
+        communicator.waitTime_ = ManualClock::now();
+        ManualClock::advance(std::chrono::milliseconds(1));
+        do {
+            communicator.handler();
+        } while(communicator.st_ != Communicator::State::idle);
+    }
+    state.SetItemsProcessed(state.iterations() * 7);
+}
+BENCHMARK(handlerSendCycle);
+
+BENCHMARK_MAIN();
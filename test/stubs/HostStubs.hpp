@@ -0,0 +1,50 @@
+#pragma once
+#include "kvasir/Util/log.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Kvasir { namespace CAN {
+    // same interface as the kvasir CAN message used by the firmware
+    struct CanMessage {
+        std::uint32_t              id_{};
+        std::uint8_t               size_{};
+        std::array<std::byte, 8> data{};
+
+        std::uint32_t id() const { return id_; }
+        std::uint8_t  size() const { return size_; }
+        void          setId(std::uint32_t id) { id_ = id; }
+        void          setSize(std::uint8_t size) { size_ = size; }
+    };
+}}   // namespace Kvasir::CAN
+
+// clock that only moves when told to
+struct ManualClock {
+    using duration   = std::chrono::milliseconds;
+    using rep        = duration::rep;
+    using period     = duration::period;
+    using time_point = std::chrono::time_point<ManualClock, duration>;
+
+    static inline time_point current{};
+
+    static time_point now() { return current; }
+    static void       advance(duration d) { current += d; }
+};
+
+// CAN that accepts every message and keeps the last one
+struct StubCan {
+    static inline Kvasir::CAN::CanMessage last{};
+    static inline std::size_t             sent{0};
+    static inline bool                    accept{true};
+
+    static bool send(Kvasir::CAN::CanMessage const& msg) {
+        if(!accept) {
+            return false;
+        }
+        last = msg;
+        ++sent;
+        return true;
+    }
+};
@@ -0,0 +1,11 @@
+#pragma once
+
+// host stand in for the kvasir logger, the firmware headers only need the macros
+template<typename... Args>
+constexpr void hostLogDiscard(Args const&...) {}
+
+#define KL_T(...) hostLogDiscard(__VA_ARGS__)
+#define KL_D(...) hostLogDiscard(__VA_ARGS__)
+#define KL_I(...) hostLogDiscard(__VA_ARGS__)
+#define KL_W(...) hostLogDiscard(__VA_ARGS__)
+#define KL_E(...) hostLogDiscard(__VA_ARGS__)